@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 #include <cmath>
+#include <memory>
 
 template <typename T>
 class Sumarray
@@ -293,7 +294,7 @@ public:
         {
             throw std::invalid_argument("Step must be positive");
         }
-        if (start < 0 || start >= dim0 || stop < 0 || stop > dim0)
+        if (start < 0 || start >= dim_zero || stop < 0 || stop > dim_zero)
         {
             throw std::out_of_range("Slicing indices out of range");
         }
@@ -318,6 +319,108 @@ public:
         return Sumarray(new_shape, data, new_offset, new_strides);
     }
 
+    // Numpy's sliding_window_view: a zero-copy view of every length-`window` window
+    // along `axis`. The axis shrinks to shape[axis] - window + 1 and a trailing
+    // dimension of size `window` is appended; windows overlap in memory. Non-const like
+    // the slicing operators, since the view can write to the shared data.
+    Sumarray sliding_window_view(int window, int axis = -1)
+    {
+        if (axis < 0)
+            axis += ndim;
+        if (axis < 0 || axis >= ndim)
+        {
+            throw std::out_of_range(fmt::format("Axis out of range: {} not in [0, {})", axis, ndim));
+        }
+        if (window < 1 || window > shape[axis])
+        {
+            throw std::invalid_argument(fmt::format("Window size must be in [1, {}]: got {}", shape[axis], window));
+        }
+
+        std::vector<int> new_shape = shape;
+        std::vector<int> new_strides = strides;
+        new_shape[axis] = shape[axis] - window + 1;
+
+        // Stepping within a window moves along the same axis as stepping between windows.
+        new_shape.push_back(window);
+        new_strides.push_back(strides[axis]);
+
+        return Sumarray(new_shape, data, offset, new_strides);
+    }
+
+    /*
+    Accessors
+    */
+
+    const std::vector<int> &get_shape() const { return shape; }
+    int get_size() const { return size; }
+    int get_ndim() const { return ndim; }
+
+    // Copy the elements into a flat row-major vector, following strides so views work too.
+    std::vector<T> to_vector() const
+    {
+        std::vector<T> out;
+        out.reserve(size);
+        for_each_position([&](int pos)
+                          { out.push_back((*data)[pos]); });
+        return out;
+    }
+
+    /*
+    Batched element access
+    */
+
+    // Numpy's take with flat row-major indices. Negative indices count from the end.
+    Sumarray take(const std::vector<int> &indices) const
+    {
+        std::vector<T> out(indices.size());
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            out[i] = (*data)[flat_to_position(indices[i])];
+        }
+        return Sumarray({static_cast<int>(indices.size())}, out);
+    }
+
+    // Numpy's put: writes values at flat row-major indices, repeating the values
+    // if there are fewer of them than indices.
+    void put(const std::vector<int> &indices, const std::vector<T> &values)
+    {
+        if (values.empty())
+        {
+            if (indices.empty())
+                return;
+            throw std::invalid_argument("Cannot put an empty set of values");
+        }
+
+        // Validate every index first so a bad index leaves the array untouched.
+        std::vector<int> positions(indices.size());
+        for (size_t i = 0; i < indices.size(); i++)
+        {
+            positions[i] = flat_to_position(indices[i]);
+        }
+        for (size_t i = 0; i < positions.size(); i++)
+        {
+            (*data)[positions[i]] = values[i % values.size()];
+        }
+    }
+
+    // Sets every element to value.
+    void fill(T value)
+    {
+        for_each_position([&](int pos)
+                          { (*data)[pos] = value; });
+    }
+
+    // Overwrites every element, in row-major order, from a buffer of exactly size elements.
+    void assign_from(const T *values, size_t count)
+    {
+        if (count != static_cast<size_t>(size))
+        {
+            throw std::invalid_argument(fmt::format("Buffer size does not match array size: {} != {}", count, size));
+        }
+        for_each_position([&](int pos)
+                          { (*data)[pos] = *values++; });
+    }
+
     /*
         Print methods
         */
@@ -373,6 +476,54 @@ private:
     Private helper functions
     */
 
+    // Calls fn(position) with the data index of each element, in row-major order.
+    template <typename Fn>
+    void for_each_position(Fn fn) const
+    {
+        if (size == 0)
+        {
+            return;
+        }
+
+        std::vector<int> index(ndim, 0);
+        int pos = offset;
+        for (int n = 0; n < size; n++)
+        {
+            fn(pos);
+
+            // Advance the multi-index like an odometer, starting from the last dimension.
+            for (int d = ndim - 1; d >= 0; d--)
+            {
+                index[d]++;
+                pos += strides[d];
+                if (index[d] < shape[d])
+                {
+                    break;
+                }
+                pos -= strides[d] * shape[d];
+                index[d] = 0;
+            }
+        }
+    }
+
+    // Maps a flat row-major index (negative counts from the end) to a data index.
+    int flat_to_position(int index) const
+    {
+        if (index < -size || index >= size)
+        {
+            throw std::out_of_range(fmt::format("Index out of range: {} not in [{}, {})", index, -size, size));
+        }
+        int flat = index < 0 ? index + size : index;
+
+        int pos = offset;
+        for (int d = ndim - 1; d >= 0; d--)
+        {
+            pos += (flat % shape[d]) * strides[d];
+            flat /= shape[d];
+        }
+        return pos;
+    }
+
     // Helper function: recursively print the array in a nested format.
     void print_recursive(int dim, int offset, int indent) const
     {
@@ -381,7 +532,7 @@ private:
             std::cout << std::string(indent, ' ') << "[";
             for (int i = 0; i < shape[dim]; i++)
             {
-                std::cout << (*data)[offset + i];
+                std::cout << (*data)[offset + strides[dim] * i];
                 if (i < shape[dim] - 1)
                 {
                     std::cout << ", ";
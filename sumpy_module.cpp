@@ -2,9 +2,154 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 #include "sumpy.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace py = pybind11;
 
+// Requests a C-contiguous buffer and calls fn with a value-initialized tag of its
+// native element type, so callers can convert with the right source type.
+template <typename Fn>
+void visit_buffer(const py::buffer &buf, Fn fn)
+{
+    py::buffer_info info = buf.request();
+
+    py::ssize_t expected = info.itemsize;
+    for (py::ssize_t d = info.ndim - 1; d >= 0; d--)
+    {
+        if (info.shape[d] > 1 && info.strides[d] != expected)
+        {
+            throw py::value_error("Buffer must be C-contiguous");
+        }
+        expected *= info.shape[d];
+    }
+
+    std::string format = info.format;
+    if (!format.empty() && (format[0] == '@' || format[0] == '=' || format[0] == '<'))
+    {
+        format = format.substr(1);
+    }
+
+    char kind = format.size() == 1 ? format[0] : '\0';
+    bool is_signed = kind != '\0' && std::string("bhilq").find(kind) != std::string::npos;
+    bool is_unsigned = kind != '\0' && std::string("BHILQ").find(kind) != std::string::npos;
+    if ((is_signed || is_unsigned) && info.itemsize == 1)
+        is_signed ? fn(info, int8_t{}) : fn(info, uint8_t{});
+    else if ((is_signed || is_unsigned) && info.itemsize == 2)
+        is_signed ? fn(info, int16_t{}) : fn(info, uint16_t{});
+    else if ((is_signed || is_unsigned) && info.itemsize == 4)
+        is_signed ? fn(info, int32_t{}) : fn(info, uint32_t{});
+    else if ((is_signed || is_unsigned) && info.itemsize == 8)
+        is_signed ? fn(info, int64_t{}) : fn(info, uint64_t{});
+    else if (kind == '?' && info.itemsize == 1)
+        fn(info, bool{});
+    else if (kind == 'f' && info.itemsize == 4)
+        fn(info, float{});
+    else if (kind == 'd' && info.itemsize == 8)
+        fn(info, double{});
+    else
+        throw py::type_error("Unsupported buffer format: " + info.format);
+}
+
+// Casts a Python sequence to a vector, raising TypeError instead of the RuntimeError
+// pybind11 gives for elements of the wrong type or out of range for U.
+template <typename U>
+std::vector<U> cast_sequence(const py::object &obj)
+{
+    try
+    {
+        return obj.cast<std::vector<U>>();
+    }
+    catch (const py::cast_error &)
+    {
+        throw py::type_error("Cannot convert " + std::string(py::str(py::type::of(obj))) +
+                             " to a sequence of " + py::type_id<U>());
+    }
+}
+
+// Converts a buffer-protocol object (array.array, numpy array, memoryview) or any
+// Python sequence of values into a flat vector in a single call. Buffer elements
+// are converted with static_cast, with the GIL released for the copy.
+template <typename U>
+std::vector<U> to_vector(const py::object &obj)
+{
+    if (!py::isinstance<py::buffer>(obj))
+    {
+        return cast_sequence<U>(obj);
+    }
+
+    std::vector<U> out;
+    visit_buffer(obj.cast<py::buffer>(), [&](const py::buffer_info &info, auto tag)
+                 {
+        using S = decltype(tag);
+        const S *src = static_cast<const S *>(info.ptr);
+        out.resize(info.size);
+        py::gil_scoped_release release;
+        std::transform(src, src + info.size, out.begin(), [](S v)
+                       { return static_cast<U>(v); }); });
+    return out;
+}
+
+// Narrows a 64-bit index to int, raising IndexError rather than wrapping.
+template <typename S>
+int checked_index(S index)
+{
+    if (!std::in_range<int>(index))
+    {
+        throw std::out_of_range(fmt::format("Index out of range: {} does not fit in a 32-bit index", index));
+    }
+    return static_cast<int>(index);
+}
+
+// Like to_vector<int>, but for indices: only integers are accepted (float and bool
+// buffers, and sequences with non-integers or values beyond 64 bits, raise TypeError)
+// and values that do not fit in an int raise IndexError.
+std::vector<int> to_indices(const py::object &obj)
+{
+    std::vector<int> out;
+    if (!py::isinstance<py::buffer>(obj))
+    {
+        std::vector<long long> wide = cast_sequence<long long>(obj);
+        out.resize(wide.size());
+        std::transform(wide.begin(), wide.end(), out.begin(), checked_index<long long>);
+        return out;
+    }
+
+    visit_buffer(obj.cast<py::buffer>(), [&](const py::buffer_info &info, auto tag)
+                 {
+        using S = decltype(tag);
+        if constexpr (!std::is_integral_v<S> || std::is_same_v<S, bool>)
+        {
+            throw py::type_error("Index buffers must have an integer format, got: " + info.format);
+        }
+        else
+        {
+            const S *src = static_cast<const S *>(info.ptr);
+            out.resize(info.size);
+            py::gil_scoped_release release;
+            std::transform(src, src + info.size, out.begin(), checked_index<S>);
+        } });
+    return out;
+}
+
+// Builds a nested Python list matching the array's shape from its flat row-major elements.
+template <typename T>
+py::object nested_list(const std::vector<T> &flat, const std::vector<int> &shape, size_t dim, size_t &pos)
+{
+    if (dim == shape.size())
+    {
+        return py::cast(flat[pos++]);
+    }
+    py::list out(shape[dim]);
+    for (int i = 0; i < shape[dim]; i++)
+    {
+        out[i] = nested_list(flat, shape, dim + 1, pos);
+    }
+    return out;
+}
+
 template <typename T>
 void declare_sumarray(py::module &m, const std::string &typestr)
 {
@@ -65,6 +210,36 @@ void declare_sumarray(py::module &m, const std::string &typestr)
             };
             
             set_element(); })
+        // Batched element access: each call crosses the Python boundary once and does
+        // the per-element work in C++ with the GIL released.
+        .def("take", [](const Class &arr, py::object indices)
+             {
+            std::vector<int> idx = to_indices(indices);
+            py::gil_scoped_release release;
+            return arr.take(idx); }, py::arg("indices"))
+        .def("put", [](Class &arr, py::object indices, py::object values)
+             {
+            std::vector<int> idx = to_indices(indices);
+            std::vector<T> vals = to_vector<T>(values);
+            py::gil_scoped_release release;
+            arr.put(idx, vals); }, py::arg("indices"), py::arg("values"))
+        .def("fill", &Class::fill, py::arg("value"), py::call_guard<py::gil_scoped_release>())
+        .def("assign_from", [](Class &arr, py::object values)
+             {
+            std::vector<T> vals = to_vector<T>(values);
+            py::gil_scoped_release release;
+            arr.assign_from(vals.data(), vals.size()); }, py::arg("values"))
+        .def("tolist", [](const Class &arr)
+             {
+            std::vector<T> flat;
+            {
+                py::gil_scoped_release release;
+                flat = arr.to_vector();
+            }
+            size_t pos = 0;
+            return nested_list(flat, arr.get_shape(), 0, pos); })
+        .def_property_readonly("shape", &Class::get_shape)
+        .def_property_readonly("size", &Class::get_size)
         .def("print", &Class::print)
         .def("print_shape", &Class::print_shape)
         .def_static("zeros", &Class::zeros)
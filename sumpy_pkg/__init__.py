@@ -102,6 +102,13 @@ class array:
         else:
             raise TypeError(f"Unsupported dtype: {dtype}")
 
+    @staticmethod
+    def frombuffer(values, shape, dtype=float):
+        """Create an array of the given shape from a buffer or sequence in one bulk copy."""
+        arr = array.zeros(shape, dtype=dtype)
+        arr.assign_from(values)
+        return arr
+
 double = float
 
 __all__ = ['array', 'Sumarray_int', 'Sumarray_float', 'Sumarray_double', 'double'] 
\ No newline at end of file
@@ -0,0 +1,313 @@
+#ifndef SIGNAL_HPP
+#define SIGNAL_HPP
+
+#include "sumpy.hpp"
+#include <algorithm>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+// Output size of a convolution, following numpy.convolve / scipy.signal.convolve2d.
+enum class ConvolveMode
+{
+    Full,  // Every point of overlap: N + M - 1 per axis.
+    Same,  // Centered: max(N, M) long for 1D as in numpy, the first input's shape for 2D as in scipy.
+    Valid, // Only points of complete overlap: max(N, M) - min(N, M) + 1 per axis.
+};
+
+// How the convolution is computed. Auto picks direct for small filters and FFT for
+// large ones; integer inputs always use the exact direct path unless FFT is forced.
+enum class ConvolveMethod
+{
+    Auto,
+    Direct,
+    FFT,
+};
+
+namespace signal_detail
+{
+    // Auto uses the FFT once direct multiply-adds exceed this multiple of N log2 N.
+    constexpr double fft_cost_factor = 4.0;
+
+    // Contiguous row-major extents of a 1D or 2D operand, viewed as rows x cols.
+    struct Extent
+    {
+        int rows;
+        int cols;
+    };
+
+    template <typename T>
+    Extent extent_of(const Sumarray<T> &arr)
+    {
+        const std::vector<int> &shape = arr.get_shape();
+        if (arr.get_ndim() == 1)
+            return {1, shape[0]};
+        return {shape[0], shape[1]};
+    }
+
+    // dst[j] += w * src[j]. The restrict parameters promise the rows never overlap and
+    // the simd pragma (enabled by -fopenmp-simd) vectorizes without a runtime alias check.
+    template <typename T>
+    inline void axpy(T *__restrict dst, const T *__restrict src, T w, int n)
+    {
+#pragma omp simd
+        for (int j = 0; j < n; j++)
+        {
+            dst[j] += w * src[j];
+        }
+    }
+
+    // Full 2D convolution by direct summation. Each filter tap scales a whole input
+    // row into the output with a vectorized axpy.
+    template <typename T>
+    std::vector<T> direct_full(const std::vector<T> &a, Extent ea, const std::vector<T> &k, Extent ek)
+    {
+        int out_cols = ea.cols + ek.cols - 1;
+        std::vector<T> out(static_cast<size_t>(ea.rows + ek.rows - 1) * out_cols, static_cast<T>(0));
+
+        for (int i = 0; i < ea.rows; i++)
+        {
+            const T *a_row = a.data() + static_cast<size_t>(i) * ea.cols;
+            for (int p = 0; p < ek.rows; p++)
+            {
+                T *out_row = out.data() + static_cast<size_t>(i + p) * out_cols;
+                for (int q = 0; q < ek.cols; q++)
+                {
+                    axpy(out_row + q, a_row, k[static_cast<size_t>(p) * ek.cols + q], ea.cols);
+                }
+            }
+        }
+        return out;
+    }
+
+    // In-place iterative radix-2 FFT; the length must be a power of two.
+    inline void fft(std::complex<double> *a, int n, int stride, bool invert)
+    {
+        for (int i = 1, j = 0; i < n; i++)
+        {
+            int bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(a[i * stride], a[j * stride]);
+        }
+
+        const double pi = std::acos(-1.0);
+        for (int len = 2; len <= n; len <<= 1)
+        {
+            double angle = 2 * pi / len * (invert ? 1 : -1);
+            std::complex<double> wlen(std::cos(angle), std::sin(angle));
+            for (int i = 0; i < n; i += len)
+            {
+                std::complex<double> w(1);
+                for (int j = 0; j < len / 2; j++)
+                {
+                    std::complex<double> u = a[(i + j) * stride];
+                    std::complex<double> v = a[(i + j + len / 2) * stride] * w;
+                    a[(i + j) * stride] = u + v;
+                    a[(i + j + len / 2) * stride] = u - v;
+                    w *= wlen;
+                }
+            }
+        }
+
+        if (invert)
+        {
+            for (int i = 0; i < n; i++)
+                a[i * stride] /= n;
+        }
+    }
+
+    // Row-column 2D FFT over a rows x cols row-major grid.
+    inline void fft2(std::vector<std::complex<double>> &grid, int rows, int cols, bool invert)
+    {
+        for (int i = 0; i < rows; i++)
+            fft(grid.data() + static_cast<size_t>(i) * cols, cols, 1, invert);
+        for (int j = 0; j < cols; j++)
+            fft(grid.data() + j, rows, cols, invert);
+    }
+
+    // Smallest power of two >= n, computed in 64 bits so extents near INT_MAX cannot overflow.
+    inline long long next_pow2(long long n)
+    {
+        long long p = 1;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    // Zero-padded FFT grid for the full convolution, or {0, 0} when the grid would not
+    // be indexable with int, which fft() uses throughout.
+    inline std::pair<int, int> fft_grid(Extent ea, Extent ek)
+    {
+        long long rows = next_pow2(static_cast<long long>(ea.rows) + ek.rows - 1);
+        long long cols = next_pow2(static_cast<long long>(ea.cols) + ek.cols - 1);
+        if (rows * cols > std::numeric_limits<int>::max())
+            return {0, 0};
+        return {static_cast<int>(rows), static_cast<int>(cols)};
+    }
+
+    // Full 2D convolution via zero-padded FFTs.
+    template <typename T>
+    std::vector<T> fft_full(const std::vector<T> &a, Extent ea, const std::vector<T> &k, Extent ek)
+    {
+        int out_rows = ea.rows + ek.rows - 1;
+        int out_cols = ea.cols + ek.cols - 1;
+        auto [rows, cols] = fft_grid(ea, ek);
+        if (rows == 0)
+        {
+            throw std::length_error(fmt::format("FFT grid too large for inputs ({}, {}) and ({}, {})",
+                                                ea.rows, ea.cols, ek.rows, ek.cols));
+        }
+
+        auto pad = [&](const std::vector<T> &src, Extent e)
+        {
+            std::vector<std::complex<double>> grid(static_cast<size_t>(rows) * cols);
+            for (int i = 0; i < e.rows; i++)
+                for (int j = 0; j < e.cols; j++)
+                    grid[static_cast<size_t>(i) * cols + j] = static_cast<double>(src[static_cast<size_t>(i) * e.cols + j]);
+            fft2(grid, rows, cols, false);
+            return grid;
+        };
+
+        std::vector<std::complex<double>> fa = pad(a, ea);
+        std::vector<std::complex<double>> fk = pad(k, ek);
+        for (size_t i = 0; i < fa.size(); i++)
+            fa[i] *= fk[i];
+        fft2(fa, rows, cols, true);
+
+        std::vector<T> out(static_cast<size_t>(out_rows) * out_cols);
+        for (int i = 0; i < out_rows; i++)
+        {
+            for (int j = 0; j < out_cols; j++)
+            {
+                double v = fa[static_cast<size_t>(i) * cols + j].real();
+                if constexpr (std::is_integral_v<T>)
+                    v = std::round(v);
+                out[static_cast<size_t>(i) * out_cols + j] = static_cast<T>(v);
+            }
+        }
+        return out;
+    }
+
+    template <typename T>
+    bool use_fft(ConvolveMethod method, Extent ea, Extent ek)
+    {
+        if (method != ConvolveMethod::Auto)
+            return method == ConvolveMethod::FFT;
+        if constexpr (std::is_integral_v<T>)
+            return false;
+
+        auto [rows, cols] = fft_grid(ea, ek);
+        if (rows == 0)
+            return false;
+
+        double direct_cost = static_cast<double>(ea.rows) * ea.cols * ek.rows * ek.cols;
+        double n = static_cast<double>(rows) * cols;
+        return direct_cost > fft_cost_factor * n * std::log2(n);
+    }
+
+    // Crops one axis of a full convolution according to the mode.
+    inline std::pair<int, int> crop(ConvolveMode mode, int n, int m)
+    {
+        switch (mode)
+        {
+        case ConvolveMode::Same:
+            return {(m - 1) / 2, n};
+        case ConvolveMode::Valid:
+            return {std::min(n, m) - 1, std::max(n, m) - std::min(n, m) + 1};
+        default:
+            return {0, n + m - 1};
+        }
+    }
+
+    template <typename T>
+    Sumarray<T> convolve(const Sumarray<T> &a, const Sumarray<T> &kernel, ConvolveMode mode, ConvolveMethod method, bool flip)
+    {
+        if (a.get_ndim() != kernel.get_ndim() || a.get_ndim() < 1 || a.get_ndim() > 2)
+        {
+            throw std::invalid_argument(fmt::format("Inputs must both be 1D or both be 2D: got {} and {} dimensions",
+                                                    a.get_ndim(), kernel.get_ndim()));
+        }
+        if (a.get_size() == 0 || kernel.get_size() == 0)
+        {
+            throw std::invalid_argument("Inputs must be non-empty");
+        }
+
+        Extent ea = extent_of(a);
+        Extent ek = extent_of(kernel);
+
+        // Cropping each axis on its own would keep partial-overlap points, so Valid
+        // needs one input to cover the other on every axis, as in scipy.signal.
+        bool a_covers = ea.rows >= ek.rows && ea.cols >= ek.cols;
+        bool kernel_covers = ek.rows >= ea.rows && ek.cols >= ea.cols;
+        if (mode == ConvolveMode::Valid && !a_covers && !kernel_covers)
+        {
+            throw std::invalid_argument(fmt::format("For Valid mode, one input must be at least as large as the other in every dimension: "
+                                                    "({}, {}) and ({}, {})",
+                                                    ea.rows, ea.cols, ek.rows, ek.cols));
+        }
+        std::vector<T> av = a.to_vector();
+        std::vector<T> kv = kernel.to_vector();
+
+        // Correlation is convolution with the kernel reversed along every axis.
+        if (flip)
+            std::reverse(kv.begin(), kv.end());
+
+        std::vector<T> full = use_fft<T>(method, ea, ek) ? fft_full(av, ea, kv, ek) : direct_full(av, ea, kv, ek);
+
+        int full_cols = ea.cols + ek.cols - 1;
+        auto [row0, rows] = crop(mode, ea.rows, ek.rows);
+        auto [col0, cols] = crop(mode, ea.cols, ek.cols);
+
+        // numpy puts the longer 1D input first. Convolution commutes, so only the crop
+        // changes; correlation of the swapped pair is the mirror image of this one.
+        if (a.get_ndim() == 1 && ek.cols > ea.cols)
+        {
+            std::tie(col0, cols) = crop(mode, ek.cols, ea.cols);
+            if (flip)
+                col0 = full_cols - col0 - cols;
+        }
+
+        // scipy.signal.correlate2d centers even-sized kernels one step later than convolve2d.
+        if (a.get_ndim() == 2 && flip && mode == ConvolveMode::Same)
+        {
+            row0 = ek.rows / 2;
+            col0 = ek.cols / 2;
+        }
+
+        std::vector<T> out;
+        out.reserve(static_cast<size_t>(rows) * cols);
+        for (int i = row0; i < row0 + rows; i++)
+        {
+            auto row = full.begin() + static_cast<size_t>(i) * full_cols;
+            out.insert(out.end(), row + col0, row + col0 + cols);
+        }
+
+        if (a.get_ndim() == 1)
+            return Sumarray<T>({cols}, out);
+        return Sumarray<T>({rows, cols}, out);
+    }
+}
+
+// Numpy's convolve for 1D inputs, extended to 2D like scipy.signal.convolve2d.
+template <typename T>
+Sumarray<T> convolve(const Sumarray<T> &a, const Sumarray<T> &kernel,
+                     ConvolveMode mode = ConvolveMode::Full, ConvolveMethod method = ConvolveMethod::Auto)
+{
+    return signal_detail::convolve(a, kernel, mode, method, false);
+}
+
+// Numpy's correlate for 1D inputs, extended to 2D like scipy.signal.correlate2d.
+// Note the default mode is Valid, as in numpy.
+template <typename T>
+Sumarray<T> correlate(const Sumarray<T> &a, const Sumarray<T> &kernel,
+                      ConvolveMode mode = ConvolveMode::Valid, ConvolveMethod method = ConvolveMethod::Auto)
+{
+    return signal_detail::convolve(a, kernel, mode, method, true);
+}
+
+#endif
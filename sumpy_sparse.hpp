@@ -0,0 +1,376 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include "sumpy.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+// Sparse 2D companion to Sumarray. Only the nonzeros are stored, either as
+// CSR (row pointers + column indices) or COO (row/column/value triplets).
+template <typename T>
+class SparseSumarray
+{
+public:
+    enum class Format
+    {
+        CSR,
+        COO
+    };
+
+    /*
+    Constructors
+    */
+
+    // Builds a sparse matrix from a dense 2D Sumarray, dropping the zeros.
+    static SparseSumarray<T> from_dense(const Sumarray<T> &dense, Format format = Format::CSR)
+    {
+        if (dense.get_ndim() != 2)
+        {
+            throw std::invalid_argument(fmt::format("Sparse arrays must be 2D: got {} dimensions", dense.get_ndim()));
+        }
+
+        const std::vector<int> &shape = dense.get_shape();
+        std::vector<T> values = dense.to_vector();
+
+        SparseSumarray<T> out(shape[0], shape[1], Format::CSR);
+        out.indptr.assign(shape[0] + 1, 0);
+        for (int i = 0; i < shape[0]; i++)
+        {
+            for (int j = 0; j < shape[1]; j++)
+            {
+                T v = values[i * shape[1] + j];
+                if (v != static_cast<T>(0))
+                {
+                    out.indices.push_back(j);
+                    out.values.push_back(v);
+                }
+            }
+            out.indptr[i + 1] = static_cast<int>(out.values.size());
+        }
+
+        return format == Format::CSR ? out : out.tocoo();
+    }
+
+    // Builds a sparse matrix from coordinate triplets. Duplicate entries are summed
+    // when the matrix is converted to CSR.
+    static SparseSumarray<T> from_triplets(const std::vector<int> &shape,
+                                           const std::vector<int> &rows,
+                                           const std::vector<int> &cols,
+                                           const std::vector<T> &values,
+                                           Format format = Format::CSR)
+    {
+        if (shape.size() != 2)
+        {
+            throw std::invalid_argument(fmt::format("Sparse arrays must be 2D: got {} dimensions", shape.size()));
+        }
+        if (shape[0] < 0 || shape[1] < 0)
+        {
+            throw std::invalid_argument(fmt::format("Shape must be non-negative: ({}, {})", shape[0], shape[1]));
+        }
+        if (rows.size() != values.size() || cols.size() != values.size())
+        {
+            throw std::invalid_argument(fmt::format("Triplet lengths do not match: {} rows, {} cols, {} values",
+                                                    rows.size(), cols.size(), values.size()));
+        }
+        for (size_t k = 0; k < values.size(); k++)
+        {
+            if (rows[k] < 0 || rows[k] >= shape[0])
+            {
+                throw std::out_of_range(fmt::format("Row index out of range: {} not in [0, {})", rows[k], shape[0]));
+            }
+            if (cols[k] < 0 || cols[k] >= shape[1])
+            {
+                throw std::out_of_range(fmt::format("Column index out of range: {} not in [0, {})", cols[k], shape[1]));
+            }
+        }
+
+        SparseSumarray<T> out(shape[0], shape[1], Format::COO);
+        out.rows = rows;
+        out.indices = cols;
+        out.values = values;
+
+        return format == Format::COO ? out : out.tocsr();
+    }
+
+    /*
+    Format conversion
+    */
+
+    // Converts to CSR with column indices sorted within each row and duplicates summed.
+    SparseSumarray<T> tocsr() const
+    {
+        if (format == Format::CSR)
+        {
+            return *this;
+        }
+
+        // Counting sort of the triplets by row.
+        SparseSumarray<T> out(n_rows, n_cols, Format::CSR);
+        std::vector<int> counts(n_rows + 1, 0);
+        for (int r : rows)
+        {
+            counts[r + 1]++;
+        }
+        for (int i = 0; i < n_rows; i++)
+        {
+            counts[i + 1] += counts[i];
+        }
+
+        std::vector<int> next(counts.begin(), counts.end() - 1);
+        std::vector<int> sorted_cols(values.size());
+        std::vector<T> sorted_values(values.size());
+        for (size_t k = 0; k < values.size(); k++)
+        {
+            int dest = next[rows[k]]++;
+            sorted_cols[dest] = indices[k];
+            sorted_values[dest] = values[k];
+        }
+
+        // Sort each row by column and merge duplicates.
+        out.indptr.assign(n_rows + 1, 0);
+        std::vector<int> order;
+        for (int i = 0; i < n_rows; i++)
+        {
+            order.resize(counts[i + 1] - counts[i]);
+            std::iota(order.begin(), order.end(), counts[i]);
+            std::sort(order.begin(), order.end(), [&](int a, int b)
+                      { return sorted_cols[a] < sorted_cols[b]; });
+
+            for (size_t k = 0; k < order.size(); k++)
+            {
+                int col = sorted_cols[order[k]];
+                if (k > 0 && col == out.indices.back())
+                {
+                    out.values.back() += sorted_values[order[k]];
+                }
+                else
+                {
+                    out.indices.push_back(col);
+                    out.values.push_back(sorted_values[order[k]]);
+                }
+            }
+            out.indptr[i + 1] = static_cast<int>(out.values.size());
+        }
+        return out;
+    }
+
+    SparseSumarray<T> tocoo() const
+    {
+        if (format == Format::COO)
+        {
+            return *this;
+        }
+
+        SparseSumarray<T> out(n_rows, n_cols, Format::COO);
+        out.rows.resize(values.size());
+        for (int i = 0; i < n_rows; i++)
+        {
+            std::fill(out.rows.begin() + indptr[i], out.rows.begin() + indptr[i + 1], i);
+        }
+        out.indices = indices;
+        out.values = values;
+        return out;
+    }
+
+    // Expands the matrix into a regular dense Sumarray. Throws std::length_error if the
+    // dense size does not fit in Sumarray's int indexing.
+    Sumarray<T> todense() const
+    {
+        if (static_cast<long long>(n_rows) * n_cols > std::numeric_limits<int>::max())
+        {
+            throw std::length_error(fmt::format("Dense size of ({}, {}) exceeds the maximum array size", n_rows, n_cols));
+        }
+        std::vector<T> dense(static_cast<size_t>(n_rows) * n_cols, static_cast<T>(0));
+        if (format == Format::COO)
+        {
+            for (size_t k = 0; k < values.size(); k++)
+            {
+                dense[static_cast<size_t>(rows[k]) * n_cols + indices[k]] += values[k];
+            }
+        }
+        else
+        {
+            for (int i = 0; i < n_rows; i++)
+            {
+                for (int k = indptr[i]; k < indptr[i + 1]; k++)
+                {
+                    dense[static_cast<size_t>(i) * n_cols + indices[k]] += values[k];
+                }
+            }
+        }
+        return Sumarray<T>({n_rows, n_cols}, dense);
+    }
+
+    // Returns the transpose in the same storage format.
+    SparseSumarray<T> transpose() const
+    {
+        // Transposing COO just swaps the coordinate arrays; CSR goes through COO.
+        SparseSumarray<T> coo = tocoo();
+        SparseSumarray<T> out(n_cols, n_rows, Format::COO);
+        out.rows = coo.indices;
+        out.indices = coo.rows;
+        out.values = coo.values;
+        return format == Format::COO ? out : out.tocsr();
+    }
+
+    /*
+    Sparse x dense multiplication
+    */
+
+    // Multiplies by a dense 1D vector or 2D matrix. Work is split across threads
+    // by row ranges holding roughly equal numbers of nonzeros; num_threads <= 0
+    // uses the hardware concurrency.
+    Sumarray<T> dot(const Sumarray<T> &dense, int num_threads = 0) const
+    {
+        if (format == Format::COO)
+        {
+            return tocsr().dot(dense, num_threads);
+        }
+
+        const std::vector<int> &dshape = dense.get_shape();
+        if (dense.get_ndim() < 1 || dense.get_ndim() > 2)
+        {
+            throw std::invalid_argument(fmt::format("Dense operand must be 1D or 2D: got {} dimensions", dense.get_ndim()));
+        }
+        if (dshape[0] != n_cols)
+        {
+            throw std::invalid_argument(fmt::format("Shapes not aligned for dot: {} != {}", n_cols, dshape[0]));
+        }
+
+        int n_rhs = dense.get_ndim() == 2 ? dshape[1] : 1;
+        std::vector<T> rhs = dense.to_vector();
+        std::vector<T> result(static_cast<size_t>(n_rows) * n_rhs, static_cast<T>(0));
+
+        auto multiply_rows = [&](int row_begin, int row_end)
+        {
+            for (int i = row_begin; i < row_end; i++)
+            {
+                T *out_row = result.data() + static_cast<size_t>(i) * n_rhs;
+                for (int k = indptr[i]; k < indptr[i + 1]; k++)
+                {
+                    const T v = values[k];
+                    const T *rhs_row = rhs.data() + static_cast<size_t>(indices[k]) * n_rhs;
+                    for (int j = 0; j < n_rhs; j++)
+                    {
+                        out_row[j] += v * rhs_row[j];
+                    }
+                }
+            }
+        };
+
+        std::vector<int> bounds = row_partitions(thread_count(num_threads, n_rhs));
+        if (bounds.size() <= 2)
+        {
+            multiply_rows(0, n_rows);
+        }
+        else
+        {
+            // Each thread owns a disjoint block of output rows, so no locking is needed.
+            std::vector<std::thread> workers;
+            for (size_t p = 0; p + 1 < bounds.size(); p++)
+            {
+                if (bounds[p] < bounds[p + 1])
+                {
+                    workers.emplace_back(multiply_rows, bounds[p], bounds[p + 1]);
+                }
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        if (dense.get_ndim() == 2)
+        {
+            return Sumarray<T>({n_rows, n_rhs}, result);
+        }
+        return Sumarray<T>({n_rows}, result);
+    }
+
+    /*
+    Accessors
+    */
+
+    std::vector<int> get_shape() const { return {n_rows, n_cols}; }
+    int nnz() const { return static_cast<int>(values.size()); }
+    Format get_format() const { return format; }
+
+    // Raw storage. For CSR, get_indptr() holds row pointers; for COO, get_rows() holds row indices.
+    const std::vector<int> &get_indptr() const { return indptr; }
+    const std::vector<int> &get_rows() const { return rows; }
+    const std::vector<int> &get_indices() const { return indices; }
+    const std::vector<T> &get_values() const { return values; }
+
+    // Splits the rows into at most `parts` contiguous ranges with roughly equal nonzero
+    // counts. Returns the boundaries, starting at 0 and ending at the number of rows.
+    std::vector<int> row_partitions(int parts) const
+    {
+        if (format != Format::CSR)
+        {
+            throw std::logic_error("Row partitions require CSR format");
+        }
+
+        parts = std::max(1, std::min(parts, n_rows));
+        std::vector<int> bounds = {0};
+        long long total = nnz();
+        for (int p = 1; p < parts; p++)
+        {
+            // First row whose starting pointer reaches this part's share of the nonzeros.
+            long long target = total * p / parts;
+            int row = static_cast<int>(std::lower_bound(indptr.begin(), indptr.end(), target) - indptr.begin());
+            row = std::min(std::max(row, bounds.back()), n_rows);
+            bounds.push_back(row);
+        }
+        bounds.push_back(n_rows);
+        return bounds;
+    }
+
+private:
+    /*
+    Member variables
+    */
+
+    int n_rows;
+    int n_cols;
+    Format format;
+    std::vector<int> indptr;  // CSR: row i spans [indptr[i], indptr[i + 1]).
+    std::vector<int> rows;    // COO: row index of each nonzero.
+    std::vector<int> indices; // Column index of each nonzero (both formats).
+    std::vector<T> values;    // Value of each nonzero (both formats).
+
+    // Minimum multiply-adds per thread before spawning more threads is worthwhile.
+    static constexpr long long min_work_per_thread = 1 << 16;
+
+    SparseSumarray(int n_rows, int n_cols, Format format)
+        : n_rows(n_rows), n_cols(n_cols), format(format)
+    {
+        if (n_rows < 0 || n_cols < 0)
+        {
+            throw std::invalid_argument("Shape must be non-negative");
+        }
+        if (format == Format::CSR)
+        {
+            indptr.assign(n_rows + 1, 0);
+        }
+    }
+
+    /*
+    Private helper functions
+    */
+
+    // Picks how many threads to use, capped so each has enough work to amortize startup.
+    int thread_count(int requested, int n_rhs) const
+    {
+        int threads = requested > 0 ? requested : static_cast<int>(std::thread::hardware_concurrency());
+        if (requested <= 0)
+        {
+            long long work = static_cast<long long>(nnz()) * n_rhs;
+            threads = static_cast<int>(std::min<long long>(threads, work / min_work_per_thread));
+        }
+        return std::max(1, threads);
+    }
+};
+
+#endif
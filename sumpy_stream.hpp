@@ -0,0 +1,463 @@
+#ifndef STREAM_HPP
+#define STREAM_HPP
+
+#include "sumpy.hpp"
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+// Out-of-core source for arrays stored in a raw binary or .npy file. Data is never
+// fully loaded: it is read in fixed-size chunks by a background thread into two
+// alternating buffers, so the next read overlaps with compute on the current chunk.
+template <typename T>
+class StreamSource
+{
+    // Only types with a fixed .npy descr are supported. Plain char is excluded because
+    // its signedness depends on the platform.
+    static_assert(std::is_same_v<T, bool> || std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                      (std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, wchar_t> &&
+                       !std::is_same_v<T, char8_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>),
+                  "StreamSource supports bool, float, double and the signed/unsigned integer types");
+
+public:
+    static constexpr std::size_t default_chunk_bytes = 1 << 23;
+
+    /*
+    Constructors
+    */
+
+    // Opens a headerless file of native-endian T values.
+    static StreamSource<T> raw(const std::string &path, std::size_t chunk_size = default_chunk_bytes / sizeof(T))
+    {
+        std::uintmax_t bytes = std::filesystem::file_size(path);
+        if (bytes % sizeof(T) != 0)
+        {
+            throw std::invalid_argument(fmt::format("File size {} is not a multiple of the element size {}", bytes, sizeof(T)));
+        }
+        long long count = static_cast<long long>(bytes / sizeof(T));
+        return StreamSource<T>(path, 0, count, {count}, "", chunk_size);
+    }
+
+    // Opens a NumPy .npy file (format versions 1-3). The dtype, including byte order,
+    // must match T on this host exactly.
+    static StreamSource<T> npy(const std::string &path, std::size_t chunk_size = default_chunk_bytes / sizeof(T))
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+        }
+
+        char magic[8];
+        in.read(magic, 8);
+        if (!in || std::string(magic, 6) != "\x93NUMPY")
+        {
+            throw std::invalid_argument(fmt::format("Not a .npy file: {}", path));
+        }
+
+        // Version 1 stores the header length in 2 bytes, versions 2 and 3 use 4.
+        int major = static_cast<unsigned char>(magic[6]);
+        if (major < 1 || major > 3)
+        {
+            throw std::invalid_argument(fmt::format("Unsupported .npy format version {}: {}", major, path));
+        }
+        unsigned char len_bytes[4] = {0, 0, 0, 0};
+        in.read(reinterpret_cast<char *>(len_bytes), major == 1 ? 2 : 4);
+        std::size_t header_len = len_bytes[0] | (len_bytes[1] << 8) | (len_bytes[2] << 16) | (static_cast<std::size_t>(len_bytes[3]) << 24);
+
+        std::string header(header_len, '\0');
+        in.read(header.data(), header_len);
+        if (!in)
+        {
+            throw std::invalid_argument(fmt::format("Truncated .npy header: {}", path));
+        }
+        long long data_offset = static_cast<long long>(in.tellg());
+
+        std::string descr = npy_field(header, "descr");
+        std::string expected = npy_descr();
+        if (descr.size() < 2 || descr.substr(1) != expected.substr(1) ||
+            (descr[0] != expected[0] && !(sizeof(T) == 1 && descr[0] == '|')))
+        {
+            throw std::invalid_argument(fmt::format("dtype mismatch: file has {}, expected {}", descr, expected));
+        }
+
+        // Element order only matters to consumers that care about the shape, so
+        // Fortran-ordered files are accepted and streamed in storage order.
+        std::vector<long long> shape;
+        std::string dims = npy_field(header, "shape");
+        long long count = 1;
+        for (std::size_t pos = 0; pos < dims.size();)
+        {
+            pos = dims.find_first_of("0123456789", pos);
+            if (pos == std::string::npos)
+            {
+                break;
+            }
+            std::size_t end = dims.find_first_not_of("0123456789", pos);
+            shape.push_back(std::stoll(dims.substr(pos, end - pos)));
+            count *= shape.back();
+            pos = end;
+        }
+
+        std::uintmax_t bytes = std::filesystem::file_size(path);
+        if (bytes < static_cast<std::uintmax_t>(data_offset) + static_cast<std::uintmax_t>(count) * sizeof(T))
+        {
+            throw std::invalid_argument(fmt::format("File too small for shape: {}", path));
+        }
+
+        in.seekg(0);
+        std::string preamble(static_cast<std::size_t>(data_offset), '\0');
+        in.read(preamble.data(), data_offset);
+        return StreamSource<T>(path, data_offset, count, shape, preamble, chunk_size);
+    }
+
+    /*
+    Accessors
+    */
+
+    long long get_count() const { return count; }
+    const std::vector<long long> &get_shape() const { return shape; }
+    std::size_t get_chunk_size() const { return chunk_size; }
+
+    /*
+    Streaming
+    */
+
+    // Calls fn(const T *chunk, std::size_t n) for each chunk in file order.
+    template <typename Fn>
+    void for_each_chunk(Fn fn) const
+    {
+        // Plain arrays rather than std::vector, which bit-packs bool.
+        std::unique_ptr<T[]> buffers[2] = {std::make_unique<T[]>(chunk_size), std::make_unique<T[]>(chunk_size)};
+        std::size_t filled[2] = {0, 0};
+        bool ready[2] = {false, false};
+        bool stop = false;
+        std::exception_ptr read_error;
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        // Producer: fill whichever buffer the consumer has released, ending with an empty chunk.
+        std::thread reader([&]()
+                           {
+            try
+            {
+                std::ifstream in(path, std::ios::binary);
+                if (!in)
+                {
+                    throw std::runtime_error(fmt::format("Cannot open file: {}", path));
+                }
+                in.seekg(data_offset);
+
+                long long remaining = count;
+                for (int slot = 0;; slot ^= 1)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock, [&]() { return !ready[slot] || stop; });
+                        if (stop)
+                        {
+                            return;
+                        }
+                    }
+
+                    std::size_t n = static_cast<std::size_t>(std::min<long long>(remaining, chunk_size));
+                    in.read(reinterpret_cast<char *>(buffers[slot].get()), n * sizeof(T));
+                    if (static_cast<std::size_t>(in.gcount()) != n * sizeof(T))
+                    {
+                        throw std::runtime_error(fmt::format("Short read from {}", path));
+                    }
+                    remaining -= n;
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        filled[slot] = n;
+                        ready[slot] = true;
+                    }
+                    cv.notify_all();
+                    if (n == 0)
+                    {
+                        return;
+                    }
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                read_error = std::current_exception();
+                stop = true;
+                cv.notify_all();
+            } });
+
+        // Consumer: process chunks in order, handing each buffer back as soon as it is done.
+        try
+        {
+            for (int slot = 0;; slot ^= 1)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [&]() { return ready[slot] || stop; });
+                    if (!ready[slot] || filled[slot] == 0)
+                    {
+                        break;
+                    }
+                }
+
+                fn(static_cast<const T *>(buffers[slot].get()), filled[slot]);
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ready[slot] = false;
+                }
+                cv.notify_all();
+            }
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            cv.notify_all();
+            reader.join();
+            throw;
+        }
+
+        reader.join();
+        if (read_error)
+        {
+            std::rethrow_exception(read_error);
+        }
+    }
+
+    /*
+    Reductions
+    */
+
+    // Folds every element into an accumulator: acc = op(acc, value).
+    template <typename Acc, typename Op>
+    Acc reduce(Acc init, Op op) const
+    {
+        Acc acc = init;
+        for_each_chunk([&](const T *chunk, std::size_t n)
+                       {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                acc = op(acc, chunk[i]);
+            } });
+        return acc;
+    }
+
+    // Type sum() accumulates and returns in: wide enough that integer totals over
+    // very large files do not overflow and float totals keep their precision.
+    using sum_type = std::conditional_t<std::is_floating_point_v<T>, double,
+                                        std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+    // Integers are summed exactly. Floats are summed pairwise within each chunk and the
+    // chunk totals combined with Kahan compensation, so error stays small over billions
+    // of elements.
+    sum_type sum() const
+    {
+        sum_type total = 0;
+        sum_type compensation = 0;
+        for_each_chunk([&](const T *chunk, std::size_t n)
+                       {
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                double y = pairwise_sum(chunk, n) - compensation;
+                double t = total + y;
+                compensation = (t - total) - y;
+                total = t;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < n; i++)
+                {
+                    total += static_cast<sum_type>(chunk[i]);
+                }
+            } });
+        return total;
+    }
+
+    T min() const
+    {
+        require_nonempty("min");
+        return reduce(std::numeric_limits<T>::max(), [](T acc, T v)
+                      { return v < acc ? v : acc; });
+    }
+
+    T max() const
+    {
+        require_nonempty("max");
+        return reduce(std::numeric_limits<T>::lowest(), [](T acc, T v)
+                      { return v > acc ? v : acc; });
+    }
+
+    // Divides the wide sum(), so integer inputs neither overflow nor truncate.
+    double mean() const
+    {
+        require_nonempty("mean");
+        return static_cast<double>(sum()) / static_cast<double>(count);
+    }
+
+    /*
+    Elementwise map and histogram
+    */
+
+    // Writes fn(value) for every element to out_path. A .npy source keeps its header,
+    // so the output is a .npy file of the same shape.
+    template <typename Fn>
+    void map_to_file(const std::string &out_path, Fn fn) const
+    {
+        // Opening the output truncates it, which would destroy the input before it is read.
+        if (std::filesystem::exists(out_path) && std::filesystem::equivalent(out_path, path))
+        {
+            throw std::invalid_argument(fmt::format("Output path is the source file: {}", out_path));
+        }
+
+        std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            throw std::runtime_error(fmt::format("Cannot open file for writing: {}", out_path));
+        }
+        out.write(preamble.data(), preamble.size());
+
+        std::unique_ptr<T[]> mapped = std::make_unique<T[]>(chunk_size);
+        for_each_chunk([&](const T *chunk, std::size_t n)
+                       {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                mapped[i] = static_cast<T>(fn(chunk[i]));
+            }
+            out.write(reinterpret_cast<const char *>(mapped.get()), n * sizeof(T));
+            if (!out)
+            {
+                throw std::runtime_error(fmt::format("Write failed: {}", out_path));
+            } });
+    }
+
+    // Counts values into `bins` equal-width bins over [lo, hi], like numpy.histogram:
+    // the last bin includes hi, and values outside the range are ignored.
+    Sumarray<long long> histogram(int bins, T lo, T hi) const
+    {
+        if (bins < 1)
+        {
+            throw std::invalid_argument("bins must be greater than 0");
+        }
+        if (!(lo < hi))
+        {
+            throw std::invalid_argument(fmt::format("Histogram range must be increasing: [{}, {}]", lo, hi));
+        }
+
+        std::vector<long long> counts(bins, 0);
+        double scale = bins / (static_cast<double>(hi) - static_cast<double>(lo));
+        for_each_chunk([&](const T *chunk, std::size_t n)
+                       {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                T v = chunk[i];
+                if (!(v >= lo && v <= hi))
+                {
+                    continue;
+                }
+                int bin = static_cast<int>((static_cast<double>(v) - static_cast<double>(lo)) * scale);
+                counts[std::min(bin, bins - 1)]++;
+            } });
+        return Sumarray<long long>({bins}, counts);
+    }
+
+private:
+    /*
+    Member variables
+    */
+
+    std::string path;
+    long long data_offset;         // Byte offset of the first element.
+    long long count;               // Total number of elements.
+    std::vector<long long> shape;  // Shape from the .npy header, or {count} for raw files.
+    std::string preamble;          // Raw header bytes copied to mapped outputs.
+    std::size_t chunk_size;        // Elements per chunk.
+
+    StreamSource(const std::string &path, long long data_offset, long long count,
+                 const std::vector<long long> &shape, const std::string &preamble, std::size_t chunk_size)
+        : path(path), data_offset(data_offset), count(count), shape(shape), preamble(preamble), chunk_size(chunk_size)
+    {
+        if (chunk_size == 0)
+        {
+            throw std::invalid_argument("Chunk size must be positive");
+        }
+    }
+
+    /*
+    Private helper functions
+    */
+
+    // Pairwise summation in double: error grows with log(n) rather than n.
+    static double pairwise_sum(const T *values, std::size_t n)
+    {
+        if (n <= 128)
+        {
+            double acc = 0;
+            for (std::size_t i = 0; i < n; i++)
+            {
+                acc += static_cast<double>(values[i]);
+            }
+            return acc;
+        }
+        std::size_t half = n / 2;
+        return pairwise_sum(values, half) + pairwise_sum(values + half, n - half);
+    }
+
+    void require_nonempty(const char *op) const
+    {
+        if (count == 0)
+        {
+            throw std::invalid_argument(fmt::format("{} of an empty stream", op));
+        }
+    }
+
+    // The .npy descr string for T in the host byte order, e.g. "<f8" on little-endian
+    // hosts. bool has no byte order and is always "|b1".
+    static std::string npy_descr()
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            return "|b1";
+        }
+        char order = std::endian::native == std::endian::little ? '<' : '>';
+        char kind = std::is_floating_point_v<T> ? 'f' : (std::is_signed_v<T> ? 'i' : 'u');
+        return fmt::format("{}{}{}", order, kind, sizeof(T));
+    }
+
+    // Extracts the raw value for `key` from the Python dict literal in a .npy header.
+    static std::string npy_field(const std::string &header, const std::string &key)
+    {
+        std::size_t pos = header.find("'" + key + "'");
+        if (pos == std::string::npos)
+        {
+            throw std::invalid_argument(fmt::format("Missing '{}' in .npy header", key));
+        }
+        pos = header.find(':', pos) + 1;
+        pos = header.find_first_not_of(' ', pos);
+
+        if (header[pos] == '\'')
+        {
+            return header.substr(pos + 1, header.find('\'', pos + 1) - pos - 1);
+        }
+        if (header[pos] == '(')
+        {
+            return header.substr(pos + 1, header.find(')', pos) - pos - 1);
+        }
+        return header.substr(pos, header.find_first_of(",}", pos) - pos);
+    }
+};
+
+#endif
@@ -16,12 +16,9 @@ void test_initializer_list_2D()
 {
     Sumarray<int> arr = {{1, 2, 3}, {4, 5, 6}};
     // Check a few values in the 2D array.
-    std::initializer_list<int> idx = {0, 0};
-    assert(arr[idx] == 1);
-    idx = {0, 1};
-    assert(arr[idx] == 2);
-    idx = {1, 2};
-    assert(arr[idx] == 6);
+    assert((arr[{0, 0}] == 1));
+    assert((arr[{0, 1}] == 2));
+    assert((arr[{1, 2}] == 6));
 }
 
 void test_constructors()
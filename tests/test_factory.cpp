@@ -55,16 +55,11 @@ void test_arange()
     // Example: arange from 0 to 10 with step 2 => 0, 2, 4, 6, 8.
 
     Sumarray<int> arr = Sumarray<int>::arange(0, 10, 2);
-    std::initializer_list<int> idx = {0};
-    assert(arr[idx] == 0);
-    idx = {1};
-    assert(arr[idx] == 2);
-    idx = {2};
-    assert(arr[idx] == 4);
-    idx = {3};
-    assert(arr[idx] == 6);
-    idx = {4};
-    assert(arr[idx] == 8);
+    assert((arr[{0}] == 0));
+    assert((arr[{1}] == 2));
+    assert((arr[{2}] == 4));
+    assert((arr[{3}] == 6));
+    assert((arr[{4}] == 8));
 }
 
 // Test for linspace.
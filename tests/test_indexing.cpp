@@ -6,12 +6,9 @@ void test_valid_indexing()
 {
     Sumarray<int> arr = {{10, 20, 30}, {40, 50, 60}};
     // Valid indexing tests.
-    std::initializer_list<int> idx = {0, 0};
-    assert(arr[idx] == 10);
-    idx = {0, 1};
-    assert(arr[idx] == 20);
-    idx = {1, 2};
-    assert(arr[idx] == 60);
+    assert((arr[{0, 0}] == 10));
+    assert((arr[{0, 1}] == 20));
+    assert((arr[{1, 2}] == 60));
 }
 
 void test_out_of_range()
@@ -30,9 +27,56 @@ void test_out_of_range()
     assert(caught);
 }
 
+void test_batched_access()
+{
+    Sumarray<int> arr = {{10, 20, 30}, {40, 50, 60}};
+    Sumarray<int> taken = arr.take({5, 0, -2});
+    assert((taken.to_vector() == std::vector<int>{60, 10, 50}));
+
+    // Values repeat when there are fewer of them than indices.
+    arr.put({0, 2, 4}, {1, 2});
+    assert((arr.to_vector() == std::vector<int>{1, 20, 2, 40, 1, 60}));
+
+    // A bad index leaves the array untouched.
+    bool caught = false;
+    try
+    {
+        arr.put({1, 6}, {0});
+    }
+    catch (const std::out_of_range &)
+    {
+        caught = true;
+    }
+    assert(caught);
+    assert((arr[{0, 1}] == 20));
+
+    // Views write through to the shared data in row-major view order.
+    Sumarray<int> col = arr.sliding_window_view(2, 0)(0)(1);
+    assert((col.to_vector() == std::vector<int>{20, 1}));
+    col.fill(7);
+    assert((arr.to_vector() == std::vector<int>{1, 7, 2, 40, 7, 60}));
+
+    std::vector<int> values = {9, 8, 7, 6, 5, 4};
+    arr.assign_from(values.data(), values.size());
+    assert(arr.to_vector() == values);
+    assert((arr.take({-1}).to_vector() == std::vector<int>{4}));
+
+    // Errors report the caller's index and the full negative-to-positive range.
+    try
+    {
+        arr.take({-10});
+        assert(false);
+    }
+    catch (const std::out_of_range &e)
+    {
+        assert(std::string(e.what()) == "Index out of range: -10 not in [-6, 6)");
+    }
+}
+
 void test_indexing()
 {
     test_valid_indexing();
     test_out_of_range();
+    test_batched_access();
     std::cout << "Indexing tests passed.\n";
 }
@@ -6,13 +6,14 @@ Tests for the Python bindings of the sumpy library.
 import sys
 import os
 import unittest
+from array import array as buffer
 
 # Add the parent directory to the Python path
 sys.path.insert(0, os.path.abspath(os.path.join(os.path.dirname(__file__), '..')))
 
 # Import the sumpy package
 try:
-    from sumpy_pkg import array
+    from sumpy_pkg import array, double
 except ImportError:
     print("Failed to import sumpy_pkg. Make sure the package is built and installed.")
     sys.exit(1)
@@ -57,5 +58,53 @@ class TestSumpyBindings(unittest.TestCase):
         full.print()
         full.print_shape()
 
+    def test_take_put(self):
+        """Test batched take and put with lists and buffers."""
+        arr = array.frombuffer(list(range(6)), [2, 3], dtype=int)
+        self.assertEqual(arr.take([5, 0, -1]).tolist(), [5, 0, 5])
+        self.assertEqual(arr.take(buffer('q', [1, 2])).tolist(), [1, 2])
+        arr.put(buffer('i', [0, 2, 4]), [7, 8])
+        self.assertEqual(arr.tolist(), [[7, 1, 8], [3, 7, 5]])
+        with self.assertRaises(IndexError):
+            arr.take([6])
+
+    def test_take_index_types(self):
+        """Test that index buffers are range-checked and must be integers."""
+        arr = array.frombuffer(list(range(6)), [6], dtype=int)
+        # 2**32 + 1 would wrap to 1 if narrowed without a check.
+        with self.assertRaises(IndexError):
+            arr.take(buffer('q', [2**32 + 1]))
+        with self.assertRaises(IndexError):
+            arr.take([2**32 + 1])
+        self.assertEqual(arr.take(buffer('q', [-1, 2])).tolist(), [5, 2])
+        with self.assertRaises(TypeError):
+            arr.take(buffer('d', [1.7]))
+        with self.assertRaises(TypeError):
+            arr.take(memoryview(bytes([1])).cast('?'))
+        with self.assertRaises(TypeError):
+            arr.put(buffer('d', [1.0]), [0])
+        # Sequences pybind11 cannot convert raise TypeError rather than RuntimeError.
+        with self.assertRaises(TypeError):
+            arr.take([1.5])
+        with self.assertRaises(TypeError):
+            arr.take([2**70])
+        with self.assertRaises(TypeError):
+            arr.put([0], ['a'])
+
+    def test_fill_tolist(self):
+        """Test fill and nested tolist."""
+        arr = array.zeros([2, 2], dtype=float)
+        arr.fill(1.5)
+        self.assertEqual(arr.tolist(), [[1.5, 1.5], [1.5, 1.5]])
+        self.assertEqual(arr.shape, [2, 2])
+
+    def test_assign_from(self):
+        """Test bulk assignment from a buffer."""
+        arr = array.zeros([3], dtype=double)
+        arr.assign_from(buffer('d', [1.0, 2.0, 3.0]))
+        self.assertEqual(arr.tolist(), [1.0, 2.0, 3.0])
+        with self.assertRaises(ValueError):
+            arr.assign_from([1.0, 2.0])
+
 if __name__ == "__main__":
     unittest.main() 
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "sumpy_signal.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+// The view is writable, so a const array must not hand one out.
+template <typename A>
+concept has_window_view = requires(A &a) { a.sliding_window_view(2); };
+static_assert(has_window_view<Sumarray<int>> && !has_window_view<const Sumarray<int>>);
+
+// Test that sliding windows are overlapping views of the original data.
+void test_sliding_window_view()
+{
+    Sumarray<int> arr = {1, 2, 3, 4, 5};
+    Sumarray<int> windows = arr.sliding_window_view(3);
+    assert((windows.get_shape() == std::vector<int>{3, 3}));
+    assert((windows[{0, 0}] == 1 && windows[{0, 2}] == 3));
+    assert((windows[{2, 0}] == 3 && windows[{2, 2}] == 5));
+
+    // Writing through one window is visible in every window that overlaps it.
+    windows[{1, 1}] = 30;
+    assert(arr[{2}] == 30);
+    assert((windows[{0, 2}] == 30 && windows[{2, 0}] == 30));
+
+    Sumarray<int> grid = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    Sumarray<int> cols = grid.sliding_window_view(2, 0);
+    assert((cols.get_shape() == std::vector<int>{2, 3, 2}));
+    assert((cols[{1, 2, 0}] == 6 && cols[{1, 2, 1}] == 9));
+    assert((cols.to_vector() == std::vector<int>{1, 4, 2, 5, 3, 6, 4, 7, 5, 8, 6, 9}));
+
+    bool caught = false;
+    try
+    {
+        arr.sliding_window_view(6);
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+}
+
+// Test 1D convolve/correlate modes against numpy's results.
+void test_convolve_1d()
+{
+    Sumarray<int> a = {1, 2, 3};
+    Sumarray<int> v = {0, 1, 2};
+    assert((convolve(a, v).to_vector() == std::vector<int>{0, 1, 4, 7, 6}));
+    assert((convolve(a, v, ConvolveMode::Same).to_vector() == std::vector<int>{1, 4, 7}));
+    assert((convolve(a, v, ConvolveMode::Valid).to_vector() == std::vector<int>{4}));
+    assert((correlate(a, v, ConvolveMode::Full).to_vector() == std::vector<int>{2, 5, 8, 3, 0}));
+    assert((correlate(a, v).to_vector() == std::vector<int>{8}));
+
+    // Same mode is max(N, M) long in 1D, even when the kernel is longer.
+    Sumarray<double> b = {1.0, 2.0, 3.0};
+    Sumarray<double> w = {0.0, 1.0, 0.5, 0.0, 0.0};
+    assert((convolve(b, w, ConvolveMode::Same).to_vector() == std::vector<double>{1.0, 2.5, 4.0, 1.5, 0.0}));
+    assert((correlate(b, w, ConvolveMode::Same).to_vector() == std::vector<double>{0.0, 0.5, 2.0, 3.5, 3.0}));
+
+    // 2D Same keeps the first input's shape and follows scipy's centering for even kernels.
+    Sumarray<int> grid = {{1, 2, 3}, {4, 5, 6}};
+    Sumarray<int> box = {{1, 1}, {1, 1}};
+    assert((correlate(grid, box, ConvolveMode::Same).to_vector() == std::vector<int>{12, 16, 9, 9, 11, 6}));
+
+    // Forcing the FFT path on integers rounds back to exact results.
+    assert((convolve(a, v, ConvolveMode::Full, ConvolveMethod::FFT).to_vector() == std::vector<int>{0, 1, 4, 7, 6}));
+}
+
+// Test that the direct and FFT paths agree, including for automatically chosen large filters.
+void test_convolve_direct_fft()
+{
+    std::vector<double> signal(500), filter(120);
+    for (size_t i = 0; i < signal.size(); ++i)
+        signal[i] = std::sin(0.1 * i);
+    for (size_t i = 0; i < filter.size(); ++i)
+        filter[i] = 1.0 / (1 + i);
+
+    Sumarray<double> a({500}, signal);
+    Sumarray<double> k({120}, filter);
+    std::vector<double> direct = convolve(a, k, ConvolveMode::Full, ConvolveMethod::Direct).to_vector();
+    std::vector<double> automatic = convolve(a, k).to_vector();
+    assert(direct.size() == 619 && automatic.size() == 619);
+    for (size_t i = 0; i < direct.size(); ++i)
+        assert(std::fabs(direct[i] - automatic[i]) < 1e-9);
+
+    Sumarray<double> image({6, 7}, std::vector<double>(signal.begin(), signal.begin() + 42));
+    Sumarray<double> kernel = {{1.0, -1.0}, {0.5, 2.0}, {0.0, 1.0}};
+    for (ConvolveMode mode : {ConvolveMode::Full, ConvolveMode::Same, ConvolveMode::Valid})
+    {
+        Sumarray<double> d = correlate(image, kernel, mode, ConvolveMethod::Direct);
+        Sumarray<double> f = correlate(image, kernel, mode, ConvolveMethod::FFT);
+        assert(d.get_shape() == f.get_shape());
+        std::vector<double> dv = d.to_vector(), fv = f.to_vector();
+        for (size_t i = 0; i < dv.size(); ++i)
+            assert(std::fabs(dv[i] - fv[i]) < 1e-9);
+    }
+
+    // Valid 2D correlation equals the sum of each window times the kernel.
+    Sumarray<double> valid = correlate(image, kernel);
+    Sumarray<double> windows = image.sliding_window_view(3, 0).sliding_window_view(2, 1);
+    assert((valid.get_shape() == std::vector<int>{4, 6}));
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 6; ++j)
+        {
+            double expected = 0;
+            for (int p = 0; p < 3; ++p)
+                for (int q = 0; q < 2; ++q)
+                    expected += windows[{i, j, p, q}] * kernel[{p, q}];
+            assert(std::fabs(valid[{i, j}] - expected) < 1e-12);
+        }
+}
+
+// Test that Valid mode rejects inputs where neither covers the other on every axis.
+void test_convolve_valid_shapes()
+{
+    Sumarray<double> image = Sumarray<double>::ones({2, 5});
+    Sumarray<double> kernel = Sumarray<double>::ones({3, 2});
+    bool caught = false;
+    try
+    {
+        convolve(image, kernel, ConvolveMode::Valid);
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    // A kernel larger on every axis is fine, as in scipy.
+    Sumarray<double> big = Sumarray<double>::ones({3, 6});
+    assert((convolve(image, big, ConvolveMode::Valid).get_shape() == std::vector<int>{2, 2}));
+}
+
+// Test that FFT sizing near INT_MAX falls back to direct or throws instead of overflowing.
+void test_fft_size_limits()
+{
+    using namespace signal_detail;
+    assert(next_pow2(1 << 30) == 1 << 30);
+    assert(next_pow2((1LL << 30) + 1) == 1LL << 31);
+
+    Extent huge = {1, 600000000};
+    assert(!use_fft<float>(ConvolveMethod::Auto, huge, huge));
+
+    bool caught = false;
+    try
+    {
+        fft_full(std::vector<float>(), huge, std::vector<float>(), huge);
+    }
+    catch (const std::length_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+}
+
+void test_signal()
+{
+    test_sliding_window_view();
+    test_convolve_1d();
+    test_convolve_direct_fft();
+    test_convolve_valid_shapes();
+    test_fft_size_limits();
+    std::cout << "Signal tests passed.\n";
+}
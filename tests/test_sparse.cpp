@@ -0,0 +1,121 @@
+#include "sumpy_sparse.hpp"
+#include <cassert>
+#include <iostream>
+
+// Test round-tripping a dense matrix through CSR and COO.
+void test_sparse_from_dense()
+{
+    Sumarray<int> dense = {{0, 2, 0}, {0, 0, 0}, {3, 0, 4}};
+    auto csr = SparseSumarray<int>::from_dense(dense);
+    assert(csr.nnz() == 3);
+    assert((csr.get_indptr() == std::vector<int>{0, 1, 1, 3}));
+    assert((csr.get_indices() == std::vector<int>{1, 0, 2}));
+
+    auto coo = SparseSumarray<int>::from_dense(dense, SparseSumarray<int>::Format::COO);
+    assert((coo.get_rows() == std::vector<int>{0, 2, 2}));
+
+    for (const auto &sparse : {csr, coo})
+    {
+        Sumarray<int> back = sparse.todense();
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                assert((back[{i, j}] == dense[{i, j}]));
+    }
+}
+
+// Test building from triplets, including duplicate summation and bounds checking.
+void test_sparse_from_triplets()
+{
+    auto csr = SparseSumarray<double>::from_triplets({2, 3}, {1, 0, 1}, {2, 1, 2}, {1.5, 2.0, 0.5});
+    assert(csr.nnz() == 2);
+    Sumarray<double> dense = csr.todense();
+    assert((dense[{0, 1}] == 2.0));
+    assert((dense[{1, 2}] == 2.0));
+
+    bool caught = false;
+    try
+    {
+        SparseSumarray<double>::from_triplets({2, 3}, {2}, {0}, {1.0});
+    }
+    catch (const std::out_of_range &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    // A negative shape is a shape error even when the indices would also be out of range.
+    caught = false;
+    try
+    {
+        SparseSumarray<double>::from_triplets({-1, 3}, {0}, {0}, {1.0});
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    // Too large to densify with int indexing, though the sparse form is tiny.
+    auto huge = SparseSumarray<double>::from_triplets({100000, 100000}, {99999}, {99999}, {1.0});
+    caught = false;
+    try
+    {
+        huge.todense();
+    }
+    catch (const std::length_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+}
+
+// Test transpose.
+void test_sparse_transpose()
+{
+    Sumarray<int> dense = {{1, 0, 0}, {0, 0, 5}};
+    Sumarray<int> t = SparseSumarray<int>::from_dense(dense).transpose().todense();
+    assert((t.get_shape() == std::vector<int>{3, 2}));
+    for (int i = 0; i < 2; ++i)
+        for (int j = 0; j < 3; ++j)
+            assert((t[{j, i}] == dense[{i, j}]));
+}
+
+// Test sparse x dense vector and matrix products, serially and across threads.
+void test_sparse_dot()
+{
+    Sumarray<int> dense = {{1, 0, 2}, {0, 0, 3}, {4, 5, 0}, {0, 0, 0}};
+    auto csr = SparseSumarray<int>::from_dense(dense);
+
+    Sumarray<int> x = {1, 2, 3};
+    for (int threads : {1, 3, 8})
+    {
+        Sumarray<int> y = csr.dot(x, threads);
+        assert((y.get_shape() == std::vector<int>{4}));
+        assert(y[{0}] == 7);
+        assert(y[{1}] == 9);
+        assert(y[{2}] == 14);
+        assert(y[{3}] == 0);
+    }
+
+    Sumarray<int> b = {{1, 0}, {0, 1}, {1, 1}};
+    Sumarray<int> c = csr.tocoo().dot(b, 2);
+    assert((c.get_shape() == std::vector<int>{4, 2}));
+    assert((c[{0, 0}] == 3 && c[{0, 1}] == 2));
+    assert((c[{1, 0}] == 3 && c[{1, 1}] == 3));
+    assert((c[{2, 0}] == 4 && c[{2, 1}] == 5));
+    assert((c[{3, 0}] == 0 && c[{3, 1}] == 0));
+
+    // Partitions cover every row exactly once.
+    std::vector<int> bounds = csr.row_partitions(3);
+    assert(bounds.front() == 0 && bounds.back() == 4);
+    assert(std::is_sorted(bounds.begin(), bounds.end()));
+}
+
+void test_sparse()
+{
+    test_sparse_from_dense();
+    test_sparse_from_triplets();
+    test_sparse_transpose();
+    test_sparse_dot();
+    std::cout << "Sparse tests passed.\n";
+}
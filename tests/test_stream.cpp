@@ -0,0 +1,220 @@
+#include "sumpy_stream.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+static std::string temp_path(const std::string &name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static void write_raw(const std::string &path, const std::vector<double> &values)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(double));
+}
+
+// Writes a version 1.0 .npy file the way numpy.save does, with the header padded to 64 bytes.
+template <typename T = double>
+static void write_npy(const std::string &path, const std::vector<T> &values, const std::string &shape,
+                      const std::string &descr = "<f8", char major = 1)
+{
+    std::string header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': " + shape + ", }";
+    header.append(64 - (10 + header.size() + 1) % 64, ' ');
+    header.push_back('\n');
+
+    std::ofstream out(path, std::ios::binary);
+    out.write("\x93NUMPY", 6);
+    out.put(major);
+    out.put(0);
+    char len[2] = {static_cast<char>(header.size() & 0xff), static_cast<char>(header.size() >> 8)};
+    out.write(len, 2);
+    out.write(header.data(), header.size());
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+// Test reductions over a raw file whose chunks do not divide the element count.
+void test_stream_reductions()
+{
+    std::string path = temp_path("sumpy_stream_raw.bin");
+    std::vector<double> values(1001);
+    for (int i = 0; i < 1001; ++i)
+        values[i] = i - 500;
+    write_raw(path, values);
+
+    auto source = StreamSource<double>::raw(path, 64);
+    assert(source.get_count() == 1001);
+    assert(source.sum() == 0.0);
+    assert(source.min() == -500.0);
+    assert(source.max() == 500.0);
+    assert(std::fabs(source.mean()) < 1e-12);
+
+    long long chunks = 0;
+    source.for_each_chunk([&](const double *, std::size_t n)
+                          { assert(n > 0 && n <= 64); chunks++; });
+    assert(chunks == 16);
+
+    std::remove(path.c_str());
+}
+
+template <typename T>
+static void write_values(const std::string &path, const std::vector<T> &values)
+{
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+// Test that sums accumulate in a wider type than the elements.
+void test_stream_wide_sum()
+{
+    std::string path = temp_path("sumpy_stream_wide.bin");
+
+    // 17000017 is past 2^24 and not representable as a float at all.
+    write_values(path, std::vector<float>(1000001, 17.0f));
+    auto floats = StreamSource<float>::raw(path, 4096);
+    static_assert(std::is_same_v<decltype(floats.sum()), double>);
+    assert(floats.sum() == 17000017.0);
+    assert(floats.mean() == 17.0);
+
+    write_values(path, std::vector<int>(3000, 1000000));
+    auto ints = StreamSource<int>::raw(path, 1000);
+    static_assert(std::is_same_v<decltype(ints.sum()), long long>);
+    assert(ints.sum() == 3000000000LL);
+
+    write_values(path, std::vector<unsigned char>(1000, 255));
+    auto bytes = StreamSource<unsigned char>::raw(path, 64);
+    static_assert(std::is_same_v<decltype(bytes.sum()), unsigned long long>);
+    assert(bytes.sum() == 255000ULL);
+
+    std::remove(path.c_str());
+}
+
+// Test .npy parsing, mapping to a new .npy file and histogramming.
+void test_stream_npy_map_histogram()
+{
+    std::string in_path = temp_path("sumpy_stream_in.npy");
+    std::string out_path = temp_path("sumpy_stream_out.npy");
+    write_npy(in_path, {0.0, 0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 3.5, 4.0, 9.0}, "(2, 5)");
+
+    auto source = StreamSource<double>::npy(in_path, 3);
+    assert((source.get_shape() == std::vector<long long>{2, 5}));
+    assert(source.sum() == 27.0);
+
+    source.map_to_file(out_path, [](double v)
+                       { return 2 * v; });
+    auto mapped = StreamSource<double>::npy(out_path);
+    assert((mapped.get_shape() == std::vector<long long>{2, 5}));
+    assert(mapped.sum() == 54.0);
+
+    // 9.0 is out of range; 4.0 falls into the closed last bin.
+    Sumarray<long long> counts = source.histogram(4, 0.0, 4.0);
+    assert(counts[{0}] == 2);
+    assert(counts[{1}] == 2);
+    assert(counts[{2}] == 2);
+    assert(counts[{3}] == 3);
+
+    bool caught = false;
+    try
+    {
+        StreamSource<float>::npy(in_path);
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    // Mapping onto the source would truncate it before it is read.
+    caught = false;
+    try
+    {
+        source.map_to_file(in_path, [](double v)
+                           { return v; });
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+    assert(source.sum() == 27.0);
+
+    // Big-endian files are rejected on a little-endian host, and vice versa.
+    std::string swapped_path = temp_path("sumpy_stream_swapped.npy");
+    write_npy(swapped_path, {1.0}, "(1,)");
+    {
+        std::fstream f(swapped_path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(10 + std::string("{'descr': '").size());
+        f.put(std::endian::native == std::endian::little ? '>' : '<');
+    }
+    caught = false;
+    try
+    {
+        StreamSource<double>::npy(swapped_path);
+    }
+    catch (const std::invalid_argument &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::remove(in_path.c_str());
+    std::remove(out_path.c_str());
+    std::remove(swapped_path.c_str());
+}
+
+// Test bool files as numpy writes them, and rejection of unknown format versions.
+void test_stream_npy_bool_and_version()
+{
+    std::string path = temp_path("sumpy_stream_bool.npy");
+    std::vector<unsigned char> flags = {1, 0, 1, 1, 0};
+    write_npy(path, flags, "(5,)", "|b1");
+    auto source = StreamSource<bool>::npy(path);
+    assert(source.sum() == 3ULL);
+    assert(source.max() == true && source.min() == false);
+
+    write_npy(path, flags, "(5,)", "|b1", 4);
+    bool caught = false;
+    try
+    {
+        StreamSource<bool>::npy(path);
+    }
+    catch (const std::invalid_argument &e)
+    {
+        caught = std::string(e.what()).find("version") != std::string::npos;
+    }
+    assert(caught);
+
+    std::remove(path.c_str());
+}
+
+// Test that an exception thrown while processing a chunk stops the reader cleanly.
+void test_stream_consumer_error()
+{
+    std::string path = temp_path("sumpy_stream_err.bin");
+    write_raw(path, std::vector<double>(100, 1.0));
+
+    bool caught = false;
+    try
+    {
+        StreamSource<double>::raw(path, 10).for_each_chunk([](const double *, std::size_t)
+                                                           { throw std::runtime_error("stop"); });
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    std::remove(path.c_str());
+}
+
+void test_stream()
+{
+    test_stream_reductions();
+    test_stream_wide_sum();
+    test_stream_npy_map_histogram();
+    test_stream_npy_bool_and_version();
+    test_stream_consumer_error();
+    std::cout << "Stream tests passed.\n";
+}
@@ -5,12 +5,18 @@ void test_constructors();
 void test_factory();
 void test_indexing();
 void test_printing();
+void test_sparse();
+void test_stream();
+void test_signal();
 
 int main() {
     test_constructors();
     test_factory();
     test_indexing();
     test_printing();
+    test_sparse();
+    test_stream();
+    test_signal();
     
     std::cout << "All tests passed!\n";
     return 0;